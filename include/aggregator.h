@@ -0,0 +1,99 @@
+#ifndef AGGREGATOR_H
+#define AGGREGATOR_H
+
+#include <sys/types.h>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "process.h"
+#include "record.h"
+#include "top_k.h"
+
+/*
+Fleet view built from many record streams (see record.h).
+Inputs are regular files, tailed through inotify, or Unix stream
+sockets; all of them are multiplexed on one epoll descriptor and read
+without blocking. Entries are applied in timestamp order with a k-way
+merge over the per-input queues, up to a watermark that inputs which
+have gone quiet no longer hold back.
+Files are tailed from their last kBacklog bytes and reopened when they
+are truncated, rotated or deleted. A host whose input has closed or gone
+quiet is flagged stale and left out of Top(); after kExpireAfter it is
+dropped.
+*/
+class Aggregator {
+ public:
+  struct Host {
+    std::string name;
+    long timestamp = 0;
+    float cpu = 0;
+    float memory = 0;
+    int running = 0;
+    int total = 0;
+    long uptime = 0;
+    bool stale = false;
+    std::size_t source = 0;  // Index of the input that last ticked it
+    std::vector<Process> processes;
+  };
+
+  bool Add(std::string const& path);
+  void Poll(int timeoutMs);
+  void Drain();
+  std::vector<Host const*> Hosts() const;  // Busiest first
+  TopK Top(std::size_t n) const;
+  std::vector<std::string> const& Errors() const;
+  std::vector<std::string> Warnings() const;
+
+  Aggregator();
+  ~Aggregator();
+  Aggregator(Aggregator const&) = delete;
+  Aggregator& operator=(Aggregator const&) = delete;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+  static constexpr int kMaxEvents{256};
+  static constexpr std::size_t kReadSize{64 * 1024};
+  static constexpr off_t kBacklog{64 * 1024};
+  static constexpr std::chrono::seconds kQuietAfter{5};
+  static constexpr std::chrono::seconds kExpireAfter{60};
+  static constexpr std::chrono::seconds kRetryAfter{1};
+
+  struct Input {
+    std::string path;
+    bool socket = false;
+    int fd = -1;
+    int watch = -1;
+    dev_t device = 0;  // Identity of the open file, to reject duplicates
+    ino_t inode = 0;
+    bool closed = false;
+    bool partial = false;  // Buffer starts mid-line after a backlog seek
+    long malformed = 0;
+    std::string buffer;
+    std::deque<Record::Entry> queue;
+    long latest = 0;
+    Clock::time_point heard;
+    Clock::time_point retry;
+    Host* host = nullptr;
+  };
+
+  bool Open(Input& input);
+  void Close(Input& input);
+  void Read(Input& input);
+  void Merge(bool all);
+  void Apply(Input& input, Record::Entry const& entry);
+  void Age();
+  void Collect();
+
+  int epoll_;
+  int inotify_;
+  std::vector<Input> inputs_;
+  std::unordered_map<int, std::size_t> watches_;
+  std::unordered_map<std::string, Host> hosts_;
+  std::vector<std::string> errors_;
+};
+
+#endif
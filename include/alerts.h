@@ -0,0 +1,101 @@
+#ifndef ALERTS_H
+#define ALERTS_H
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "system.h"
+
+/*
+Rule engine evaluated against each System snapshot.
+Rules are read from a config file, one per line:
+  proc.cpu > 90 for 10s
+  mem.available < 5%
+  log /var/log/monitor-alerts.log
+  exec /usr/local/bin/notify-oncall
+Percent metrics (cpu.utilization, mem.*, proc.cpu) use a 0 - 100 scale.
+They are compiled once into a flat plan; Evaluate() only reads values
+already collected by System::Refresh() and reuses its buffers.
+proc.cpu rules use the busiest-first order of the process table and
+only visit matching rows; proc.ram and proc.uptime rules have no such
+index and cost one pass over the table per rule and tick.
+Process state is tracked per (pid, start time), so a reused pid starts
+a new hold period instead of inheriting the old process's alert.
+The exec hook runs once per transition, with stdio on /dev/null. For
+proc.* rules that means one /bin/sh per matching process, so a broad
+rule such as "proc.cpu >= 0" forks for every listed process at once.
+*/
+class AlertEngine {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  enum class Metric {
+    kCpuUtilization,
+    kMemUtilization,
+    kMemAvailable,
+    kProcsRunning,
+    kProcsTotal,
+    kProcCpu,
+    kProcRam,
+    kProcUpTime
+  };
+  enum class Op { kGreater, kGreaterEqual, kLess, kLessEqual };
+
+  bool Load(std::string const& path);
+  bool Compile(std::string const& line);
+  void Evaluate(System& system, Clock::time_point now = Clock::now());
+
+  bool Empty() const;
+  int FiringCount() const;
+  bool IsFiring(Process const& proc) const;
+  bool HasHook() const;
+  std::vector<std::string> const& Errors() const;
+  std::string FiringSummary() const;
+
+ private:
+  struct Pending {
+    int pid;
+    long start;
+    Clock::time_point since;
+    bool firing;
+    bool operator<(Pending const& a) const {
+      return pid < a.pid || (pid == a.pid && start < a.start);
+    }
+  };
+  struct Rule {
+    std::string text;
+    Metric metric;
+    Op op;
+    float threshold;
+    Clock::duration hold;
+    // System-scope state
+    bool matched = false;
+    Clock::time_point since;
+    bool firing = false;
+    // Process-scope state, sorted by (pid, start); next is swapped in each tick
+    std::vector<Pending> pending;
+    std::vector<Pending> next;
+  };
+
+  static bool ProcScope(Metric metric);
+  static float Value(Metric metric, Process const& proc);
+  static float Value(Metric metric, System& system);
+  static bool Matches(Op op, float value, float threshold);
+
+  void EvaluateSystem(Rule& rule, System& system, Clock::time_point now);
+  void EvaluateProcesses(Rule& rule, std::vector<Process> const& processes,
+                         Clock::time_point now);
+  void Notify(Rule const& rule, bool firing, int pid, float value);
+
+  std::vector<Rule> rules_;
+  std::vector<std::pair<Pending, float>> matched_;
+  std::vector<std::string> errors_;
+  std::ofstream log_;
+  std::string hook_;
+  int firing_ = 0;
+};
+
+#endif
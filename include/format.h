@@ -2,9 +2,11 @@
 #define FORMAT_H
 
 #include <string>
+#include <string_view>
 
 namespace Format {
 std::string ElapsedTime(long times);  // DONE: See src/format.cpp
+std::string_view Truncate(std::string_view text, std::size_t width);
 };                                    // namespace Format
 
 #endif
\ No newline at end of file
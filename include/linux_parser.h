@@ -4,6 +4,7 @@
 #include <fstream>
 #include <regex>
 #include <string>
+#include <vector>
 
 template <typename Type> Type safe_convert(std::string s);
 
@@ -17,6 +18,7 @@ const std::string kStatFilename{"/stat"};
 const std::string kUptimeFilename{"/uptime"};
 const std::string kMeminfoFilename{"/meminfo"};
 const std::string kVersionFilename{"/version"};
+const std::string kBootIdFilename{"sys/kernel/random/boot_id"};
 const std::string kOSPath{"/etc/os-release"};
 const std::string kPasswordPath{"/etc/passwd"};
 
@@ -24,6 +26,7 @@ const std::string kPasswordPath{"/etc/passwd"};
 const std::string filterPrettyName{"PRETTY_NAME"};
 const std::string filterMemTotal{"MemTotal"};
 const std::string filterMemFree{"MemFree"};
+const std::string filterMemAvailable{"MemAvailable"};
 const std::string filterProcesses{"processes"};
 const std::string filterProcsRunning{"procs_running"};
 const std::string filterVmRSS{"VmRSS"}; // Use VmRSS, not VmSize
@@ -31,12 +34,14 @@ const std::string filterUid{"Uid"};
 
 // System
 float MemoryUtilization();
+float MemoryAvailable();
 long UpTime();
 std::vector<int> Pids();
 int TotalProcesses();
 int RunningProcesses();
 std::string OperatingSystem();
 std::string Kernel();
+std::string BootId();
 
 // CPU
 enum CPUStates {
@@ -54,9 +59,11 @@ enum CPUStates {
   
 std::vector<std::string> CpuUtilization();
 long Jiffies();
+long Jiffies(std::vector<std::string> const& cpu);
 long ActiveJiffies();
 long ActiveJiffies(int pid);
 long IdleJiffies();
+long IdleJiffies(std::vector<std::string> const& cpu);
 
 // Processes
 std::string Command(int pid);
@@ -64,6 +71,15 @@ std::string Ram(int pid);
 std::string Uid(int pid);
 std::string User(int pid);
 long int UpTime(int pid);
+
+// Processes: single-read helpers for scanning many PIDs
+std::vector<std::string> Stat(int pid);
+std::vector<std::string> Status(int pid, std::vector<std::string> const& keys);
+long ActiveJiffies(std::vector<std::string> const& stat);
+long int UpTime(std::vector<std::string> const& stat, long systemUpTime);
+long StartTime(std::vector<std::string> const& stat);
+long Rss(std::vector<std::string> const& stat);
+std::string UserFromUid(std::string const& uid);
 };  // namespace LinuxParser
 
 #endif
\ No newline at end of file
@@ -3,13 +3,21 @@
 
 #include <curses.h>
 
+#include "aggregator.h"
+#include "alerts.h"
 #include "process.h"
 #include "system.h"
 
 namespace NCursesDisplay {
-void Display(System& system, int n = 10);
-void DisplaySystem(System& system, WINDOW* window);
-void DisplayProcesses(std::vector<Process>& processes, WINDOW* window, int n);
+void Display(System& system, int n = 10, AlertEngine* alerts = nullptr);
+void DisplaySystem(System& system, WINDOW* window,
+                   AlertEngine const* alerts = nullptr);
+void DisplayProcesses(std::vector<Process>& processes, WINDOW* window, int n,
+                      AlertEngine const* alerts = nullptr);
+void DisplayFleet(Aggregator& fleet, int n = 10, int hosts = 10);
+void DisplayHosts(std::vector<Aggregator::Host const*> const& hosts,
+                  std::vector<std::string> const& warnings, WINDOW* window,
+                  int n);
 std::string ProgressBar(float percent);
 };  // namespace NCursesDisplay
 
@@ -2,26 +2,54 @@
 #define PROCESS_H
 
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "string_interner.h"
 /*
 Basic class for Process representation
 It contains relevant attributes as shown below
+User and command strings live in StringInterner::Global(); a Process
+only holds handles to them so rows can be copied and moved cheaply.
+CPU, RAM and uptime are sampled once at construction so comparisons
+and readers (sorting, alerts) never go back to /proc.
+CPU is the lifetime average until System supplies a baseline through
+Interval(); it is a percentage of one core.
 */
 class Process {
  public:
   int Pid() const;                               // DONE: See src/process.cpp
-  std::string User() const;                      // DONE: See src/process.cpp
-  std::string Command() const;                   // DONE: See src/process.cpp
+  std::string_view User() const;                 // DONE: See src/process.cpp
+  std::string_view Command() const;              // DONE: See src/process.cpp
   float CpuUtilization() const;                  // DONE: See src/process.cpp
   std::string Ram() const;                       // DONE: See src/process.cpp
+  long RamMb() const;
+  long Jiffies() const;
+  long StartTime() const;
+  void Interval(long previousJiffies, float elapsedJiffies);
+  void LoadName();
+  void LoadDetails();
+  void Mark() const;
   long int UpTime() const;                       // DONE: See src/process.cpp
   bool operator<(Process const& a) const;  // DONE: See src/process.cpp
 
-  Process(int pid);
+  Process(int pid, std::vector<std::string> const& stat, long systemUpTime);
+  Process(int pid, std::string_view user, std::string_view command, float cpu,
+          long ramMb, long upTime);
   // DONE: Declare any necessary private members
  private:
   int pid;
-  std::string user;
-  std::string cmd;
+  StringInterner::Handle user;
+  StringInterner::Handle cmd;
+  float cpu;
+  long ram;
+  long int uptime;
+  long jiffies;
+  long start;
 };
 
-#endif
\ No newline at end of file
+static_assert(std::is_trivially_copyable<Process>::value,
+              "Process rows must stay trivially copyable");
+
+#endif
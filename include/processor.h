@@ -1,10 +1,22 @@
 #ifndef PROCESSOR_H
 #define PROCESSOR_H
 
+/*
+Utilization is measured between consecutive Update() calls. Until a
+baseline exists (first sample, no warm-start) it is the since-boot
+average.
+*/
 class Processor {
  public:
   float Utilization();  // DONE: See src/processor.cpp
+  void Update();        // Sample /proc/stat; Utilization() returns the result
+  void Baseline(long active, long total);
+  long ActiveJiffies() const;
+  long Jiffies() const;
  private:
+  float utilization_ = 0;
+  long active_ = 0;
+  long total_ = 0;
 };
 
-#endif
\ No newline at end of file
+#endif
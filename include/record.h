@@ -0,0 +1,40 @@
+#ifndef RECORD_H
+#define RECORD_H
+
+#include <ostream>
+#include <string>
+
+#include "system.h"
+
+/*
+Compact per-tick record stream, one self-contained line per entry:
+  H <time ms> <host> <cpu %> <memory %> <running> <total> <uptime s>
+  P <time ms> <pid> <cpu %> <ram MB> <uptime s> <user> <command...>
+An unknown user or an empty command is written as "-".
+Each tick is one H line followed by the host's busiest processes,
+all with the same timestamp. Written by 'monitor --record' and read
+back by the Aggregator.
+*/
+namespace Record {
+struct Entry {
+  char kind = 0;  // 'H' or 'P'
+  long timestamp = 0;
+  std::string host;
+  float cpu = 0;
+  float memory = 0;
+  int running = 0;
+  int total = 0;
+  int pid = 0;
+  long ram = 0;
+  long uptime = 0;
+  std::string user;
+  std::string command;
+};
+
+long Now();
+void Write(std::ostream& out, System& system, std::string const& host,
+           std::size_t n);
+bool Parse(std::string const& line, Entry& entry);
+};  // namespace Record
+
+#endif
@@ -1,13 +1,15 @@
 #ifndef STDOUT_DISPLAY_H
 #define STDOUT_DISPLAY_H
 
+#include "aggregator.h"
 #include "process.h"
 #include "system.h"
 
 namespace StdOutDisplay {
 void Display(System& system, int n = 10);
 void DisplaySystem(System& system);
-void DisplayProcesses(std::vector<Process>& processes, int n);
+void DisplayProcesses(std::vector<Process>& processes, int n, float total);
+void DisplayFleet(Aggregator& fleet, int n = 10);
 };  // namespace StdOutDisplay
 
 #endif
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef STRING_INTERNER_H
+#define STRING_INTERNER_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/*
+Arena-backed pool for strings shared by many processes (usernames,
+command lines). Each distinct string is stored once and referred to
+by a small Handle, so Process rows stay trivially copyable.
+Handle 0 is always the empty string. Safe to use from several threads.
+
+The owner of the live rows (System or Aggregator) calls Mark() on each
+of their handles once per snapshot and then Sweep(): unmarked strings
+are released and their handles reused, and the arena is compacted
+once most of it is garbage. Views returned by View() are only valid
+until the next Sweep().
+*/
+class StringInterner {
+ public:
+  using Handle = std::uint32_t;
+
+  Handle Intern(std::string_view s);
+  std::string_view View(Handle handle) const;
+  void Mark(Handle handle);
+  void Sweep();
+
+  static StringInterner& Global();
+
+  StringInterner();
+  StringInterner(StringInterner const&) = delete;
+  StringInterner& operator=(StringInterner const&) = delete;
+
+ private:
+  static constexpr std::size_t kBlockSize{64 * 1024};
+  std::string_view Store(std::string_view s);
+  void Compact();
+
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char* current_ = nullptr;
+  std::size_t used_ = 0;
+  std::size_t arena_bytes_ = 0;
+  std::size_t live_bytes_ = 0;
+  std::vector<std::string_view> strings_;
+  std::vector<bool> marked_;
+  std::vector<Handle> free_;
+  std::unordered_map<std::string_view, Handle> index_;
+  mutable std::mutex mutex_;
+};
+
+#endif
@@ -2,29 +2,65 @@
 #define SYSTEM_H
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "process.h"
 #include "processor.h"
+#include "top_k.h"
 
+/*
+Getters return the values collected by the last Refresh(), so every
+reader of a tick (displays, alerts) sees the same snapshot.
+Processes() is sorted busiest first. CPU figures are rates since the
+previous scan, or since the baselines restored by LoadState(). Only the
+rows passed to RefreshDetails() have a user and command line.
+*/
 class System {
  public:
   Processor& Cpu();                   // DONE: See src/system.cpp
   std::vector<Process>& Processes();  // DONE: See src/system.cpp
   float MemoryUtilization();          // DONE: See src/system.cpp
+  float MemoryAvailable();
   long UpTime();                      // DONE: See src/system.cpp
   int TotalProcesses();               // DONE: See src/system.cpp
   int RunningProcesses();             // DONE: See src/system.cpp
   std::string Kernel();               // DONE: See src/system.cpp
   std::string OperatingSystem();      // DONE: See src/system.cpp
+  void Refresh(std::size_t n);
+  void RefreshCounters();
+  void RefreshRanking(std::size_t n);
+  void RefreshDetails(std::size_t n);
+  std::vector<Process>& ScanTop(std::size_t k);
+  float TotalCpu();
+  bool LoadState(std::string const& path);
+  bool SaveState(std::string const& path);
 
   System();
   // DONE: Define any necessary private members
  private:
+  static constexpr std::size_t kPidsPerThread{256};
+  struct Baseline {
+    long start;
+    long jiffies;
+  };
+
+  static bool Listed(Process const& proc);
+  TopK Scan(std::size_t k);
+  void Collect();
+
   Processor cpu_ = {};
   std::vector<Process> processes_;
   std::string os_;
   std::string kernel_;
+  float memory_utilization_ = 0;
+  float memory_available_ = 0;
+  long up_time_ = 0;
+  int total_processes_ = 0;
+  int running_processes_ = 0;
+  std::unordered_map<int, Baseline> baseline_;
+  long baseline_jiffies_ = 0;
+  float total_cpu_ = 0;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,31 @@
+#ifndef TOP_K_H
+#define TOP_K_H
+
+#include <cstddef>
+#include <vector>
+
+#include "process.h"
+
+/*
+Streaming selection of the K processes with the highest CPU.
+A bounded min-heap keeps the current top K, so each Push is O(log K);
+totals over every pushed process are accumulated in the same pass.
+Scan threads each fill their own TopK and Merge them at the end.
+*/
+class TopK {
+ public:
+  explicit TopK(std::size_t k);
+  void Push(Process const& proc);
+  void Merge(TopK const& other);
+  std::vector<Process> Sorted() const;  // Highest CPU first
+  float TotalCpu() const;
+
+ private:
+  void Insert(Process const& proc);
+
+  std::size_t k_;
+  std::vector<Process> heap_;
+  float total_cpu_ = 0;
+};
+
+#endif
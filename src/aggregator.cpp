@@ -0,0 +1,380 @@
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/inotify.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "aggregator.h"
+#include "top_k.h"
+
+using std::string;
+using std::vector;
+
+namespace {
+// inotify events are told apart from inputs by this epoll tag
+constexpr std::uint64_t kInotifyTag{std::numeric_limits<std::uint64_t>::max()};
+}  // namespace
+
+Aggregator::Aggregator()
+    : epoll_{epoll_create1(EPOLL_CLOEXEC)},
+      inotify_{inotify_init1(IN_NONBLOCK | IN_CLOEXEC)} {
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.u64 = kInotifyTag;
+  epoll_ctl(epoll_, EPOLL_CTL_ADD, inotify_, &event);
+}
+
+Aggregator::~Aggregator() {
+  for (Input& input : inputs_) {
+    Close(input);
+  }
+  close(inotify_);
+  close(epoll_);
+}
+
+// Register a record stream; regular files are read from their last
+// kBacklog bytes, enough for the latest ticks without loading history
+bool Aggregator::Add(string const& path) {
+  struct stat info;
+  if (stat(path.c_str(), &info) != 0) {
+    errors_.emplace_back(path + ": " + std::strerror(errno));
+    return false;
+  }
+  if (!S_ISREG(info.st_mode) && !S_ISSOCK(info.st_mode)) {
+    errors_.emplace_back(path + ": not a file or Unix socket");
+    return false;
+  }
+  // Two paths to one file would share an inotify watch descriptor
+  for (Input const& other : inputs_) {
+    if (!other.socket && !S_ISSOCK(info.st_mode) &&
+        other.device == info.st_dev && other.inode == info.st_ino) {
+      errors_.emplace_back(path + ": same file as " + other.path);
+      return false;
+    }
+  }
+  Input input;
+  input.path = path;
+  input.socket = S_ISSOCK(info.st_mode);
+  inputs_.push_back(std::move(input));
+  if (!Open(inputs_.back())) {
+    errors_.emplace_back(path + ": " + std::strerror(errno));
+    inputs_.pop_back();
+    return false;
+  }
+  Input& added = inputs_.back();
+  if (!added.socket && info.st_size > kBacklog) {
+    lseek(added.fd, info.st_size - kBacklog, SEEK_SET);
+    added.partial = true;
+  }
+  Read(added);
+  return true;
+}
+
+bool Aggregator::Open(Input& input) {
+  std::uint64_t index = &input - inputs_.data();
+  input.closed = false;
+  input.partial = false;
+  input.buffer.clear();
+  if (input.socket) {
+    input.fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, input.path.c_str(),
+                 sizeof(address.sun_path) - 1);
+    if (input.fd < 0 ||
+        connect(input.fd, reinterpret_cast<sockaddr*>(&address),
+                sizeof(address)) != 0) {
+      Close(input);
+      return false;
+    }
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLRDHUP;
+    event.data.u64 = index;
+    epoll_ctl(epoll_, EPOLL_CTL_ADD, input.fd, &event);
+    input.heard = Clock::now();
+    return true;
+  }
+  // Regular files cannot be polled, so wake up on inotify writes instead;
+  // a moved or deleted file is closed and reopened by path (log rotation)
+  input.fd = open(input.path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+  if (input.fd < 0) {
+    Close(input);
+    return false;
+  }
+  struct stat info;
+  input.watch = inotify_add_watch(inotify_, input.path.c_str(),
+                                  IN_MODIFY | IN_MOVE_SELF | IN_DELETE_SELF);
+  if (watches_.count(input.watch) > 0) {
+    // Same inode as another input: the watch is theirs, leave it be
+    input.watch = -1;
+    errno = EEXIST;
+  }
+  if (input.watch < 0 || fstat(input.fd, &info) != 0) {
+    Close(input);
+    return false;
+  }
+  input.device = info.st_dev;
+  input.inode = info.st_ino;
+  watches_[input.watch] = index;
+  input.heard = Clock::now();
+  return true;
+}
+
+void Aggregator::Close(Input& input) {
+  if (input.watch >= 0) {
+    inotify_rm_watch(inotify_, input.watch);
+    watches_.erase(input.watch);
+    input.watch = -1;
+  }
+  if (input.fd >= 0) {
+    close(input.fd);  // Also removes it from the epoll set
+    input.fd = -1;
+  }
+  input.closed = true;
+  input.retry = Clock::now() + kRetryAfter;
+}
+
+// Read whatever is available and queue the complete lines
+void Aggregator::Read(Input& input) {
+  struct stat info;
+  if (!input.socket && input.fd >= 0 && fstat(input.fd, &info) == 0 &&
+      info.st_size < lseek(input.fd, 0, SEEK_CUR)) {
+    // Truncated in place: start over from the new beginning
+    lseek(input.fd, 0, SEEK_SET);
+    input.buffer.clear();
+    input.partial = false;
+  }
+  char chunk[kReadSize];
+  while (input.fd >= 0) {
+    ssize_t size = read(input.fd, chunk, sizeof(chunk));
+    if (size > 0) {
+      input.buffer.append(chunk, size);
+    } else if (size < 0 && errno == EINTR) {
+      continue;
+    } else if ((size == 0 && !input.socket) || (size < 0 && errno == EAGAIN)) {
+      // End of file only means "nothing yet" for a tailed file
+      break;
+    } else {
+      Close(input);
+    }
+  }
+
+  std::size_t begin = 0;
+  std::size_t end;
+  if (input.partial && (end = input.buffer.find('\n')) != string::npos) {
+    begin = end + 1;
+    input.partial = false;
+  }
+  Record::Entry entry;
+  while ((end = input.buffer.find('\n', begin)) != string::npos) {
+    if (Record::Parse(input.buffer.substr(begin, end - begin), entry)) {
+      input.latest = std::max(input.latest, entry.timestamp);
+      input.queue.push_back(entry);
+      input.heard = Clock::now();
+    } else {
+      input.malformed++;
+    }
+    begin = end + 1;
+  }
+  if (begin > 0) {
+    input.buffer.erase(0, begin);
+  }
+}
+
+// Wait up to timeoutMs for input, then merge what is safe to apply
+void Aggregator::Poll(int timeoutMs) {
+  Clock::time_point now = Clock::now();
+  for (Input& input : inputs_) {
+    // Reopened files may already hold lines written since the rotation
+    if (input.closed && now >= input.retry && Open(input)) {
+      Read(input);
+    }
+  }
+
+  epoll_event events[kMaxEvents];
+  int ready = epoll_wait(epoll_, events, kMaxEvents, timeoutMs);
+  for (int i = 0; i < ready; i++) {
+    if (events[i].data.u64 != kInotifyTag) {
+      Read(inputs_[events[i].data.u64]);
+      continue;
+    }
+    alignas(inotify_event) char buffer[4096];
+    ssize_t size;
+    while ((size = read(inotify_, buffer, sizeof(buffer))) > 0) {
+      for (char* p = buffer; p < buffer + size;) {
+        auto* event = reinterpret_cast<inotify_event*>(p);
+        auto found = watches_.find(event->wd);
+        if (found != watches_.end()) {
+          Input& input = inputs_[found->second];
+          Read(input);
+          if (event->mask & (IN_MOVE_SELF | IN_DELETE_SELF)) {
+            Close(input);
+          }
+        }
+        p += sizeof(inotify_event) + event->len;
+      }
+    }
+  }
+  Merge(false);
+}
+
+// Apply everything queued regardless of the watermark, e.g. for a
+// one-shot summary of files
+void Aggregator::Drain() {
+  for (Input& input : inputs_) {
+    Read(input);
+  }
+  Merge(true);
+}
+
+/*
+k-way merge: a min-heap holds the head of each input queue, so entries
+leave in global timestamp order while each input stays in file order.
+Entries newer than the slowest live input are held back until it
+catches up; inputs that are closed, quiet for kQuietAfter or have not
+produced a valid entry yet do not count.
+*/
+void Aggregator::Merge(bool all) {
+  long watermark = std::numeric_limits<long>::max();
+  if (!all) {
+    Clock::time_point now = Clock::now();
+    for (Input const& input : inputs_) {
+      if (!input.closed && input.latest > 0 &&
+          now - input.heard < kQuietAfter) {
+        watermark = std::min(watermark, input.latest);
+      }
+    }
+  }
+
+  using Head = std::pair<long, std::size_t>;
+  std::priority_queue<Head, vector<Head>, std::greater<Head>> heads;
+  for (std::size_t i = 0; i < inputs_.size(); i++) {
+    if (!inputs_[i].queue.empty()) {
+      heads.emplace(inputs_[i].queue.front().timestamp, i);
+    }
+  }
+  while (!heads.empty() && heads.top().first <= watermark) {
+    Input& input = inputs_[heads.top().second];
+    heads.pop();
+    Apply(input, input.queue.front());
+    input.queue.pop_front();
+    if (!input.queue.empty()) {
+      heads.emplace(input.queue.front().timestamp, &input - inputs_.data());
+    }
+  }
+  Age();
+  Collect();
+}
+
+// Flag hosts whose input closed or went quiet; drop them once that has
+// lasted kExpireAfter
+void Aggregator::Age() {
+  Clock::time_point now = Clock::now();
+  for (auto host = hosts_.begin(); host != hosts_.end();) {
+    Input const& source = inputs_[host->second.source];
+    host->second.stale = source.closed || now - source.heard >= kQuietAfter;
+    if (now - source.heard < kExpireAfter) {
+      ++host;
+      continue;
+    }
+    for (Input& input : inputs_) {
+      if (input.host == &host->second) {
+        input.host = nullptr;
+      }
+    }
+    host = hosts_.erase(host);
+  }
+}
+
+// Release interned strings of process rows that have been replaced
+void Aggregator::Collect() {
+  for (auto const& [name, host] : hosts_) {
+    for (Process const& proc : host.processes) {
+      proc.Mark();
+    }
+  }
+  StringInterner::Global().Sweep();
+}
+
+// A host line starts a new tick for that host; process lines join the
+// tick of the host line before them on the same input. A tick older
+// than the one shown, e.g. from a lagging second input for the same
+// host, is skipped along with its process lines.
+void Aggregator::Apply(Input& input, Record::Entry const& entry) {
+  if (entry.kind == 'H') {
+    Host& host = hosts_[entry.host];
+    if (entry.timestamp < host.timestamp) {
+      input.host = nullptr;
+      return;
+    }
+    if (host.timestamp != entry.timestamp) {
+      host.processes.clear();
+    }
+    host.name = entry.host;
+    host.timestamp = entry.timestamp;
+    host.cpu = entry.cpu;
+    host.memory = entry.memory;
+    host.running = entry.running;
+    host.total = entry.total;
+    host.uptime = entry.uptime;
+    host.source = &input - inputs_.data();
+    input.host = &host;
+    return;
+  }
+  if (input.host != nullptr && input.host->timestamp == entry.timestamp) {
+    input.host->processes.emplace_back(
+        entry.pid, entry.user, input.host->name + ": " + entry.command,
+        entry.cpu, entry.ram, entry.uptime);
+  }
+}
+
+vector<Aggregator::Host const*> Aggregator::Hosts() const {
+  vector<Host const*> hosts;
+  for (auto const& [name, host] : hosts_) {
+    hosts.push_back(&host);
+  }
+  std::sort(hosts.begin(), hosts.end(), [](Host const* a, Host const* b) {
+    return a->cpu > b->cpu;
+  });
+  return hosts;
+}
+
+// Busiest processes across every live host, from each host's latest
+// tick; TotalCpu() covers every recorded row, not just the n kept
+TopK Aggregator::Top(std::size_t n) const {
+  TopK top(n);
+  for (auto const& [name, host] : hosts_) {
+    if (host.stale) {
+      continue;
+    }
+    for (Process const& proc : host.processes) {
+      top.Push(proc);
+    }
+  }
+  return top;
+}
+
+vector<string> const& Aggregator::Errors() const { return errors_; }
+
+// One line per input that had lines it could not parse
+vector<string> Aggregator::Warnings() const {
+  vector<string> warnings;
+  for (Input const& input : inputs_) {
+    if (input.malformed > 0) {
+      warnings.push_back(input.path + ": " + std::to_string(input.malformed) +
+                         " malformed lines skipped");
+    }
+  }
+  return warnings;
+}
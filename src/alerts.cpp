@@ -0,0 +1,374 @@
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "alerts.h"
+
+using std::string;
+using std::to_string;
+using std::vector;
+
+namespace {
+struct MetricName {
+  const char* name;
+  AlertEngine::Metric metric;
+};
+
+const MetricName kMetricNames[] = {
+    {"cpu.utilization", AlertEngine::Metric::kCpuUtilization},
+    {"mem.utilization", AlertEngine::Metric::kMemUtilization},
+    {"mem.available", AlertEngine::Metric::kMemAvailable},
+    {"procs.running", AlertEngine::Metric::kProcsRunning},
+    {"procs.total", AlertEngine::Metric::kProcsTotal},
+    {"proc.cpu", AlertEngine::Metric::kProcCpu},
+    {"proc.ram", AlertEngine::Metric::kProcRam},
+    {"proc.uptime", AlertEngine::Metric::kProcUpTime},
+};
+
+bool parseNumber(string token, float& value) {
+  if (!token.empty() && token.back() == '%') {
+    token.pop_back();
+  }
+  try {
+    size_t used = 0;
+    value = std::stof(token, &used);
+    return used == token.size();
+  } catch (...) {
+    return false;
+  }
+}
+
+// "10s", "5m", "1h" or plain seconds
+bool parseDuration(string token, std::chrono::seconds& hold) {
+  long scale = 1;
+  if (!token.empty() && std::isalpha(token.back())) {
+    switch (token.back()) {
+      case 's': scale = 1; break;
+      case 'm': scale = 60; break;
+      case 'h': scale = 3600; break;
+      default: return false;
+    }
+    token.pop_back();
+  }
+  float value = 0;
+  if (!parseNumber(token, value) || value < 0) {
+    return false;
+  }
+  hold = std::chrono::seconds(static_cast<long>(value * scale));
+  return true;
+}
+}  // namespace
+
+bool AlertEngine::Load(string const& path) {
+  std::ifstream stream(path);
+  if (!stream.is_open()) {
+    errors_.emplace_back(path + ": cannot open alert rules");
+    return false;
+  }
+  string line;
+  int lineNumber = 0;
+  bool ok = true;
+  while (std::getline(stream, line)) {
+    ++lineNumber;
+    if (!Compile(line)) {
+      errors_.back() = path + ":" + to_string(lineNumber) + ": " + errors_.back();
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+// Compile one config line into the plan; blank lines and # comments are skipped
+bool AlertEngine::Compile(string const& line) {
+  string text = line.substr(0, line.find('#'));
+  std::istringstream linestream(text);
+  string first;
+  if (!(linestream >> first)) {
+    return true;
+  }
+
+  if (first == "log" || first == "exec") {
+    string rest;
+    std::getline(linestream >> std::ws, rest);
+    if (rest.empty()) {
+      errors_.emplace_back(first + " needs an argument");
+      return false;
+    }
+    if (first == "log") {
+      log_.close();
+      log_.open(rest, std::ios::app);
+      if (!log_.is_open()) {
+        errors_.emplace_back("cannot open log " + rest);
+        return false;
+      }
+    } else {
+      hook_ = rest;
+    }
+    return true;
+  }
+
+  if (first.rfind("cgroup(", 0) == 0) {
+    errors_.emplace_back("'" + first + "': cgroup metrics are not sampled");
+    return false;
+  }
+
+  Rule rule;
+  auto name = std::find_if(std::begin(kMetricNames), std::end(kMetricNames),
+                           [&](MetricName const& m) { return first == m.name; });
+  if (name == std::end(kMetricNames)) {
+    errors_.emplace_back("unknown metric '" + first + "'");
+    return false;
+  }
+  rule.metric = name->metric;
+
+  string op, threshold;
+  linestream >> op >> threshold;
+  if (op == ">") {
+    rule.op = Op::kGreater;
+  } else if (op == ">=") {
+    rule.op = Op::kGreaterEqual;
+  } else if (op == "<") {
+    rule.op = Op::kLess;
+  } else if (op == "<=") {
+    rule.op = Op::kLessEqual;
+  } else {
+    errors_.emplace_back("expected >, >=, < or <= after " + first);
+    return false;
+  }
+  if (!parseNumber(threshold, rule.threshold)) {
+    errors_.emplace_back("bad threshold '" + threshold + "'");
+    return false;
+  }
+
+  std::chrono::seconds hold{0};
+  string keyword, duration;
+  if (linestream >> keyword) {
+    if (keyword != "for" || !(linestream >> duration) ||
+        !parseDuration(duration, hold)) {
+      errors_.emplace_back("expected 'for <N>s' after threshold");
+      return false;
+    }
+  }
+  string extra;
+  if (linestream >> extra) {
+    errors_.emplace_back("unexpected '" + extra + "'");
+    return false;
+  }
+  rule.hold = hold;
+
+  std::istringstream normalized(text);
+  for (string token; normalized >> token;) {
+    rule.text += (rule.text.empty() ? "" : " ") + token;
+  }
+  rules_.push_back(std::move(rule));
+  return true;
+}
+
+bool AlertEngine::ProcScope(Metric metric) {
+  return metric == Metric::kProcCpu || metric == Metric::kProcRam ||
+         metric == Metric::kProcUpTime;
+}
+
+// Percentages are reported on a 0 - 100 scale to match the config syntax
+float AlertEngine::Value(Metric metric, System& system) {
+  switch (metric) {
+    case Metric::kCpuUtilization: return system.Cpu().Utilization() * 100;
+    case Metric::kMemUtilization: return system.MemoryUtilization() * 100;
+    case Metric::kMemAvailable: return system.MemoryAvailable() * 100;
+    case Metric::kProcsRunning: return system.RunningProcesses();
+    case Metric::kProcsTotal: return system.TotalProcesses();
+    default: return 0;
+  }
+}
+
+float AlertEngine::Value(Metric metric, Process const& proc) {
+  switch (metric) {
+    case Metric::kProcCpu: return proc.CpuUtilization();
+    case Metric::kProcRam: return proc.RamMb();
+    case Metric::kProcUpTime: return proc.UpTime();
+    default: return 0;
+  }
+}
+
+bool AlertEngine::Matches(Op op, float value, float threshold) {
+  switch (op) {
+    case Op::kGreater: return value > threshold;
+    case Op::kGreaterEqual: return value >= threshold;
+    case Op::kLess: return value < threshold;
+    case Op::kLessEqual: return value <= threshold;
+  }
+  return false;
+}
+
+void AlertEngine::Evaluate(System& system, Clock::time_point now) {
+  firing_ = 0;
+  for (Rule& rule : rules_) {
+    if (ProcScope(rule.metric)) {
+      EvaluateProcesses(rule, system.Processes(), now);
+    } else {
+      EvaluateSystem(rule, system, now);
+    }
+  }
+}
+
+void AlertEngine::EvaluateSystem(Rule& rule, System& system,
+                                 Clock::time_point now) {
+  float value = Value(rule.metric, system);
+  if (!Matches(rule.op, value, rule.threshold)) {
+    if (rule.firing) {
+      Notify(rule, false, -1, value);
+    }
+    rule.matched = false;
+    rule.firing = false;
+    return;
+  }
+  if (!rule.matched) {
+    rule.matched = true;
+    rule.since = now;
+  }
+  if (!rule.firing && now - rule.since >= rule.hold) {
+    rule.firing = true;
+    Notify(rule, true, -1, value);
+  }
+  firing_ += rule.firing;
+}
+
+void AlertEngine::EvaluateProcesses(Rule& rule,
+                                    vector<Process> const& processes,
+                                    Clock::time_point now) {
+  auto first = processes.begin();
+  auto last = processes.end();
+  // System keeps processes sorted busiest first, so proc.cpu matches
+  // are a contiguous range found by binary search
+  if (rule.metric == Metric::kProcCpu) {
+    auto matches = [&](Process const& p) {
+      return Matches(rule.op, p.CpuUtilization(), rule.threshold);
+    };
+    if (rule.op == Op::kGreater || rule.op == Op::kGreaterEqual) {
+      last = std::partition_point(first, last, matches);
+    } else {
+      first = std::partition_point(first, last, [&](Process const& p) {
+        return !matches(p);
+      });
+    }
+  }
+
+  // proc.ram and proc.uptime have no order to exploit: one full pass
+  matched_.clear();
+  for (auto proc = first; proc != last; ++proc) {
+    float value = Value(rule.metric, *proc);
+    if (Matches(rule.op, value, rule.threshold)) {
+      matched_.emplace_back(
+          Pending{proc->Pid(), proc->StartTime(), now, false}, value);
+    }
+  }
+  std::sort(matched_.begin(), matched_.end(),
+            [](auto const& a, auto const& b) { return a.first < b.first; });
+
+  // Merge this tick's matches with the pending entries, both sorted by
+  // (pid, start); a pid reused by a new process is a different entry
+  rule.next.clear();
+  auto previous = rule.pending.begin();
+  for (auto const& [match, value] : matched_) {
+    for (; previous != rule.pending.end() && *previous < match; ++previous) {
+      if (previous->firing) {
+        Notify(rule, false, previous->pid, 0);
+      }
+    }
+    Pending entry = match;
+    if (previous != rule.pending.end() && !(match < *previous)) {
+      entry = *previous++;
+    }
+    if (!entry.firing && now - entry.since >= rule.hold) {
+      entry.firing = true;
+      Notify(rule, true, entry.pid, value);
+    }
+    firing_ += entry.firing;
+    rule.next.push_back(entry);
+  }
+  for (; previous != rule.pending.end(); ++previous) {
+    if (previous->firing) {
+      Notify(rule, false, previous->pid, 0);
+    }
+  }
+  std::swap(rule.pending, rule.next);
+}
+
+// Append the transition to the log and/or start the hook with details
+// in its environment (ALERT_STATE, ALERT_RULE, ALERT_PID, ALERT_VALUE)
+void AlertEngine::Notify(Rule const& rule, bool firing, int pid, float value) {
+  const char* state = firing ? "FIRING" : "RESOLVED";
+  if (log_.is_open()) {
+    std::time_t wall = std::time(nullptr);
+    log_ << std::put_time(std::localtime(&wall), "%FT%T") << " " << state
+         << " " << rule.text;
+    if (pid >= 0) {
+      log_ << " pid=" << pid;
+    }
+    if (firing || pid < 0) {
+      log_ << " value=" << value;
+    }
+    log_ << std::endl;
+  }
+  if (!hook_.empty() && fork() == 0) {
+    // Keep hook output off the ncurses screen
+    int null = open("/dev/null", O_RDWR);
+    dup2(null, STDIN_FILENO);
+    dup2(null, STDOUT_FILENO);
+    dup2(null, STDERR_FILENO);
+    setenv("ALERT_STATE", state, 1);
+    setenv("ALERT_RULE", rule.text.c_str(), 1);
+    setenv("ALERT_PID", to_string(pid).c_str(), 1);
+    setenv("ALERT_VALUE", to_string(value).c_str(), 1);
+    execl("/bin/sh", "sh", "-c", hook_.c_str(), static_cast<char*>(nullptr));
+    _exit(127);
+  }
+}
+
+bool AlertEngine::Empty() const { return rules_.empty(); }
+
+int AlertEngine::FiringCount() const { return firing_; }
+
+bool AlertEngine::IsFiring(Process const& proc) const {
+  Pending key{proc.Pid(), proc.StartTime(), {}, false};
+  for (Rule const& rule : rules_) {
+    auto found =
+        std::lower_bound(rule.pending.begin(), rule.pending.end(), key);
+    if (found != rule.pending.end() && !(key < *found) && found->firing) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool AlertEngine::HasHook() const { return !hook_.empty(); }
+
+vector<string> const& AlertEngine::Errors() const { return errors_; }
+
+// Firing rule texts, with the number of firing processes for proc rules
+string AlertEngine::FiringSummary() const {
+  string summary;
+  for (Rule const& rule : rules_) {
+    int count = rule.firing;
+    for (Pending const& entry : rule.pending) {
+      count += entry.firing;
+    }
+    if (count == 0) {
+      continue;
+    }
+    summary += (summary.empty() ? "" : ", ") + rule.text;
+    if (ProcScope(rule.metric)) {
+      summary += " (" + to_string(count) + ")";
+    }
+  }
+  return summary;
+}
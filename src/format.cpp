@@ -28,4 +28,9 @@ string Format::ElapsedTime(long seconds) {
         SS = "0" + SS;
     }
     return HH + ":" + MM + ":" + SS;
-}
\ No newline at end of file
+}
+
+// Clip text to width characters without copying it
+std::string_view Format::Truncate(std::string_view text, std::size_t width) {
+    return text.substr(0, width);
+}
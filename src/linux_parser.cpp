@@ -7,7 +7,7 @@
 
 #include "linux_parser.h"
 
-using std::stof;
+using std::stod;
 using std::string;
 using std::to_string;
 using std::vector;
@@ -42,7 +42,7 @@ Type safe_convert(string s)
   Type f = 0;
   try
   {
-    f = (Type) stof(s);
+    f = (Type) stod(s);
   }
   catch(...) {}
   return f;
@@ -174,6 +174,17 @@ float LinuxParser::MemoryUtilization() {
   return (total - free) / total;
 }
 
+// Read and return the fraction of memory available for new allocations
+float LinuxParser::MemoryAvailable() {
+  File file{kProcDirectory + kMeminfoFilename};
+  float total = file.findNumValue<float>(filterMemTotal);
+  float available = file.findNumValue<float>(filterMemAvailable);
+  if (total == 0) {
+    return 0;
+  }
+  return available / total;
+}
+
 // DONE: Read and return the system uptime (in seconds)
 long LinuxParser::UpTime() {
   File file{kProcDirectory + kUptimeFilename};
@@ -193,9 +204,13 @@ Total = Idle + NonIdle
 
 // DONE: Read and return the number of jiffies for the system
 long LinuxParser::Jiffies() {
-  vector<string> cpuUtils = CpuUtilization();
+  return Jiffies(CpuUtilization());
+}
+
+// Guest time is already included in user and nice, so stop at steal
+long LinuxParser::Jiffies(vector<string> const& cpuUtils) {
   long jiffies = 0;
-  for (size_t i = 1; i < cpuUtils.size(); i++)
+  for (size_t i = 0; i < cpuUtils.size() && i <= CPUStates::kSteal_; i++)
   {
     jiffies += safe_convert<long>(cpuUtils[i]);
   }
@@ -205,10 +220,16 @@ long LinuxParser::Jiffies() {
 // DONE: Read and return the number of active jiffies for a PID
 // REMOVE: [[maybe_unused]] once you define the function
 long LinuxParser::ActiveJiffies(int pid) {
-  File file{kProcDirectory + to_string(pid) + kStatFilename};
-  vector<string> fields = file.findLineVector();
-  long utime = safe_convert<long>(fields[14-1]);
-  long stime = safe_convert<long>(fields[15-1]);
+  return ActiveJiffies(Stat(pid));
+}
+
+long LinuxParser::ActiveJiffies(vector<string> const& stat) {
+  // The process may have exited since Pids() listed it
+  if (stat.size() < 15) {
+    return 0;
+  }
+  long utime = safe_convert<long>(stat[14-1]);
+  long stime = safe_convert<long>(stat[15-1]);
   return utime + stime; // + cutime + cstime;
 }
 
@@ -219,7 +240,13 @@ long LinuxParser::ActiveJiffies() {
 
 // DONE: Read and return the number of idle jiffies for the system
 long LinuxParser::IdleJiffies() {
-  vector<string> cpuUtils = CpuUtilization();
+  return IdleJiffies(CpuUtilization());
+}
+
+long LinuxParser::IdleJiffies(vector<string> const& cpuUtils) {
+  if (cpuUtils.size() <= CPUStates::kIOwait_) {
+    return 0;
+  }
   long jiffies = 0;
   jiffies += safe_convert<long>(cpuUtils[CPUStates::kIdle_]);
   jiffies += safe_convert<long>(cpuUtils[CPUStates::kIOwait_]);
@@ -234,6 +261,13 @@ vector<string> LinuxParser::CpuUtilization() {
   return cpuUtils;
 }
 
+// Random UUID the kernel picks at boot; unlike btime it does not move
+// when the wall clock is stepped
+string LinuxParser::BootId() {
+  File file{kProcDirectory + kBootIdFilename};
+  return file.findValue();
+}
+
 // DONE: Read and return the total number of processes
 int LinuxParser::TotalProcesses() {
   File file{kProcDirectory + kStatFilename};
@@ -271,15 +305,78 @@ string LinuxParser::Uid(int pid) {
 // DONE: Read and return the user associated with a process
 // REMOVE: [[maybe_unused]] once you define the function
 string LinuxParser::User(int pid) { 
+  return UserFromUid(Uid(pid));
+}
+
+// Read and return the user name for a numeric user ID
+string LinuxParser::UserFromUid(string const& uid) {
   File file{kPasswordPath};
-  return file.findValue(Uid(pid), 2, 0);
+  return file.findValue(uid, 2, 0);
 }
 
 // DONE: Read and return the uptime of a process
 // REMOVE: [[maybe_unused]] once you define the function
 long LinuxParser::UpTime(int pid) {
+  return UpTime(Stat(pid), UpTime());
+}
+
+long LinuxParser::UpTime(vector<string> const& stat, long systemUpTime) {
+  if (stat.size() < 22) {
+    return 0;
+  }
+  float stime = safe_convert<float>(stat[22 - 1]);
+  return systemUpTime - (stime / sysconf(_SC_CLK_TCK));
+}
+
+// Start time in clock ticks after boot; together with the PID it
+// identifies a process across PID reuse
+long LinuxParser::StartTime(vector<string> const& stat) {
+  if (stat.size() < 22) {
+    return 0;
+  }
+  return safe_convert<long>(stat[22 - 1]);
+}
+
+// Resident set size in kB, the same figure as VmRSS in status
+long LinuxParser::Rss(vector<string> const& stat) {
+  if (stat.size() < 24) {
+    return 0;
+  }
+  return safe_convert<long>(stat[24 - 1]) * sysconf(_SC_PAGESIZE) / 1024;
+}
+
+// Read /proc/[pid]/stat once and split it into fields.
+// The command name (field 2) may contain spaces, so it is cut out
+// between the first '(' and the last ')' before splitting the rest.
+vector<string> LinuxParser::Stat(int pid) {
   File file{kProcDirectory + to_string(pid) + kStatFilename};
-  //string starttime = file.findValue(22 - 1);
-  float stime = file.findNumValue<float>(22 - 1);
-  return UpTime() - (stime / sysconf(_SC_CLK_TCK));
+  string line = file.findLine();
+  size_t open = line.find('(');
+  size_t close = line.rfind(')');
+  if (open == string::npos || close == string::npos || close < open) {
+    return {};
+  }
+  vector<string> fields{line.substr(0, open - 1),
+                        line.substr(open + 1, close - open - 1)};
+  for (string& value : vectorFromLine(line.substr(close + 1))) {
+    fields.emplace_back(std::move(value));
+  }
+  return fields;
+}
+
+// Read /proc/[pid]/status once and return the value of each key, in order
+vector<string> LinuxParser::Status(int pid, vector<string> const& keys) {
+  vector<string> values(keys.size());
+  std::ifstream stream(kProcDirectory + to_string(pid) + kStatusFilename);
+  string line;
+  while (std::getline(stream, line)) {
+    std::replace(line.begin(), line.end(), ':', ' ');
+    string key = valueFromLine(line, 0);
+    for (size_t i = 0; i < keys.size(); i++) {
+      if (key == keys[i]) {
+        values[i] = valueFromLine(line, 1);
+      }
+    }
+  }
+  return values;
 }
@@ -1,9 +1,145 @@
+#include <unistd.h>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "aggregator.h"
+#include "alerts.h"
 #include "ncurses_display.h"
+#include "record.h"
 #include "stdout_display.h"
 #include "system.h"
 
-int main() {
+namespace {
+// Cleared by SIGINT/SIGTERM so --record can stop and save its state
+volatile std::sig_atomic_t recording = 1;
+void stopRecording(int) { recording = 0; }
+
+int usage(const char* program) {
+  std::cerr << "usage: " << program
+            << " [--alerts FILE] [--state FILE] [--batch] [-n ROWS]\n"
+            << "       " << program
+            << " --record FILE|- [--host NAME] [-n ROWS]\n"
+            << "       " << program
+            << " --aggregate PATH... [--batch] [-n ROWS]\n";
+  return 1;
+}
+
+int fail(std::vector<std::string> const& errors) {
+  for (auto const& error : errors) {
+    std::cerr << error << "\n";
+  }
+  return 1;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  AlertEngine alerts;
+  std::string state;
+  std::string record;
+  std::string host;
+  std::vector<std::string> aggregate;
+  bool batch = false;
+  int n = 10;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg{argv[i]};
+    if (arg == "--alerts" && i + 1 < argc) {
+      alerts.Load(argv[++i]);
+    } else if (arg == "--state" && i + 1 < argc) {
+      state = argv[++i];
+    } else if (arg == "--record" && i + 1 < argc) {
+      record = argv[++i];
+    } else if (arg == "--host" && i + 1 < argc) {
+      host = argv[++i];
+    } else if (arg == "--aggregate" && i + 1 < argc) {
+      while (i + 1 < argc && argv[i + 1][0] != '-') {
+        aggregate.emplace_back(argv[++i]);
+      }
+      if (aggregate.empty()) {
+        return usage(argv[0]);
+      }
+    } else if (arg == "--batch") {
+      batch = true;
+    } else if (arg == "-n" && i + 1 < argc && std::atoi(argv[i + 1]) > 0) {
+      n = std::atoi(argv[++i]);
+    } else {
+      return usage(argv[0]);
+    }
+  }
+  if (!alerts.Errors().empty()) {
+    return fail(alerts.Errors());
+  }
+  if (host.find_first_of(" \t\n\v\f\r") != std::string::npos) {
+    return fail({"--host: '" + host + "' must not contain whitespace"});
+  }
+  if (!alerts.Empty() && (batch || !record.empty() || !aggregate.empty())) {
+    return fail({"--alerts only applies to the interactive view of this host"});
+  }
+  if (alerts.HasHook()) {
+    // Hooks are fire-and-forget; let the kernel reap them
+    signal(SIGCHLD, SIG_IGN);
+  }
+
+  if (!aggregate.empty()) {
+    Aggregator fleet;
+    for (auto const& path : aggregate) {
+      fleet.Add(path);
+    }
+    if (!fleet.Errors().empty()) {
+      return fail(fleet.Errors());
+    }
+    if (batch) {
+      fleet.Drain();
+      StdOutDisplay::DisplayFleet(fleet, n);
+      for (auto const& warning : fleet.Warnings()) {
+        std::cerr << warning << "\n";
+      }
+    } else {
+      NCursesDisplay::DisplayFleet(fleet, n);
+    }
+    return 0;
+  }
+
   System system;
-  //StdOutDisplay::Display(system);
-  NCursesDisplay::Display(system);
-}
\ No newline at end of file
+  if (!state.empty() && std::ifstream(state).good() &&
+      !system.LoadState(state)) {
+    std::cerr << state
+              << ": ignoring state from another boot or in a bad format\n";
+  }
+  if (!record.empty()) {
+    if (host.empty()) {
+      char name[256] = {};
+      gethostname(name, sizeof(name) - 1);
+      host = name;
+    }
+    std::ofstream file;
+    if (record != "-") {
+      file.open(record, std::ios::app);
+    }
+    std::ostream& out = record == "-" ? std::cout : file;
+    signal(SIGINT, stopRecording);
+    signal(SIGTERM, stopRecording);
+    while (out && recording) {
+      system.ScanTop(n);
+      Record::Write(out, system, host, n);
+      out.flush();
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+    if (!out) {
+      std::cerr << record << ": write failed\n";
+      return 1;
+    }
+  } else if (batch) {
+    StdOutDisplay::Display(system, n);
+  } else {
+    NCursesDisplay::Display(system, n, alerts.Empty() ? nullptr : &alerts);
+  }
+  if (!state.empty()) {
+    system.SaveState(state);
+  }
+}
@@ -1,5 +1,6 @@
 #include <curses.h>
 #include <chrono>
+#include <csignal>
 #include <string>
 #include <thread>
 #include <vector>
@@ -12,6 +13,13 @@
 using std::string;
 using std::to_string;
 
+namespace {
+// Cleared by SIGINT/SIGTERM so Display() can restore the terminal and
+// return, letting main() save the warm-start state
+volatile std::sig_atomic_t running = 1;
+void stop(int) { running = 0; }
+}  // namespace
+
 // 50 bars uniformly displayed from 0 - 100 %
 // 2% is one bar(|)
 std::string NCursesDisplay::ProgressBar(float percent) {
@@ -29,10 +37,11 @@ std::string NCursesDisplay::ProgressBar(float percent) {
   return result + " " + display + "/100%";
 }
 
-void NCursesDisplay::DisplaySystem(System& system, WINDOW* window) {
+void NCursesDisplay::DisplaySystem(System& system, WINDOW* window,
+                                   AlertEngine const* alerts) {
   int row{0};
-  mvwprintw(window, ++row, 2, ("OS: " + system.OperatingSystem()).c_str());
-  mvwprintw(window, ++row, 2, ("Kernel: " + system.Kernel()).c_str());
+  mvwprintw(window, ++row, 2, "OS: %s", system.OperatingSystem().c_str());
+  mvwprintw(window, ++row, 2, "Kernel: %s", system.Kernel().c_str());
   mvwprintw(window, ++row, 2, "CPU: ");
   wattron(window, COLOR_PAIR(1));
   mvwprintw(window, row, 10, "");
@@ -50,11 +59,24 @@ void NCursesDisplay::DisplaySystem(System& system, WINDOW* window) {
       ("Running Processes: " + to_string(system.RunningProcesses())).c_str());
   mvwprintw(window, ++row, 2,
             ("Up Time: " + Format::ElapsedTime(system.UpTime())).c_str());
+  if (alerts != nullptr) {
+    mvwprintw(window, ++row, 2, string(window->_maxx - 2, ' ').c_str());
+    mvwprintw(window, row, 2, "Alerts: ");
+    if (alerts->FiringCount() > 0) {
+      wattron(window, COLOR_PAIR(3));
+      string summary = alerts->FiringSummary();
+      waddnstr(window, summary.c_str(), window->_maxx - 12);
+      wattroff(window, COLOR_PAIR(3));
+    } else {
+      wprintw(window, "none firing");
+    }
+  }
   wrefresh(window);
 }
 
 void NCursesDisplay::DisplayProcesses(std::vector<Process>& processes,
-                                      WINDOW* window, int n) {
+                                      WINDOW* window, int n,
+                                      AlertEngine const* alerts) {
   int row{0};
   int const pid_column{2};
   int const user_column{9};
@@ -73,42 +95,165 @@ void NCursesDisplay::DisplayProcesses(std::vector<Process>& processes,
   int nOfProc = processes.size();
   for (int i = 0; i < n && i < nOfProc; ++i) {
     // Clear the line
-	float cpu = processes[i].CpuUtilization() * 100;    
+	float cpu = processes[i].CpuUtilization();
     mvwprintw(window, ++row, pid_column, (string(window->_maxx-2, ' ').c_str()));
+    bool firing = alerts != nullptr && alerts->IsFiring(processes[i]);
+    if (firing) wattron(window, COLOR_PAIR(3));
     mvwprintw(window, row, pid_column, to_string(processes[i].Pid()).c_str());
-    mvwprintw(window, row, user_column, processes[i].User().c_str());
+    std::string_view user =
+        Format::Truncate(processes[i].User(), cpu_column - user_column - 1);
+    mvwaddnstr(window, row, user_column, user.data(), user.size());
     mvwprintw(window, row, cpu_column, to_string(cpu).substr(0, 4).c_str());
     mvwprintw(window, row, ram_column, processes[i].Ram().c_str());
     mvwprintw(window, row, time_column,
               Format::ElapsedTime(processes[i].UpTime()).c_str());
-    mvwprintw(window, row, command_column,
-              processes[i].Command().substr(0, window->_maxx - 46).c_str());
+    std::string_view command = Format::Truncate(
+        processes[i].Command(), window->_maxx - command_column);
+    mvwaddnstr(window, row, command_column, command.data(), command.size());
+    if (firing) wattroff(window, COLOR_PAIR(3));
   }
 }
 
-void NCursesDisplay::Display(System& system, int n) {
+void NCursesDisplay::Display(System& system, int n, AlertEngine* alerts) {
   initscr();      // start ncurses
   noecho();       // do not print input values
   cbreak();       // terminate ncurses on ctrl + c
   start_color();  // enable color
+  running = 1;
+  signal(SIGINT, stop);
+  signal(SIGTERM, stop);
 
   int x_max{getmaxx(stdscr)};
-  WINDOW* system_window = newwin(9, x_max - 1, 0, 0);
+  // One extra row for the alert summary
+  WINDOW* system_window = newwin(alerts ? 10 : 9, x_max - 1, 0, 0);
   WINDOW* process_window =
       newwin(3 + n, x_max - 1, system_window->_maxy + 1, 0);
+  init_pair(1, COLOR_BLUE, COLOR_BLACK);
+  init_pair(2, COLOR_GREEN, COLOR_BLACK);
+  init_pair(3, COLOR_RED, COLOR_BLACK);
 
-  std::sort(system.Processes().begin(), system.Processes().end());
-  while (1) {
-    init_pair(1, COLOR_BLUE, COLOR_BLACK);
-    init_pair(2, COLOR_GREEN, COLOR_BLACK);
+  auto draw = [&](bool processes) {
     box(system_window, 0, 0);
     box(process_window, 0, 0);
-    DisplaySystem(system, system_window);
-    DisplayProcesses(system.Processes(), process_window, n);
+    DisplaySystem(system, system_window, alerts);
+    if (processes) {
+      DisplayProcesses(system.Processes(), process_window, n, alerts);
+    }
     wrefresh(system_window);
     wrefresh(process_window);
     refresh();
+  };
+
+  // The first frame is drawn in stages so something useful shows at once:
+  // the system panel, a stat-only ranking, then the full rows
+  system.RefreshCounters();
+  draw(false);
+  system.RefreshRanking(n);
+  draw(true);
+  system.RefreshDetails(n);
+  draw(true);
+
+  while (running) {
     std::this_thread::sleep_for(std::chrono::seconds(1));
+    system.Refresh(n);
+    if (alerts) alerts->Evaluate(system);
+    draw(true);
+  }
+  endwin();
+}
+
+// Busiest hosts of the fleet, one summary row each
+void NCursesDisplay::DisplayHosts(
+    std::vector<Aggregator::Host const*> const& hosts,
+    std::vector<std::string> const& warnings, WINDOW* window, int n) {
+  int row{0};
+  int const host_column{2};
+  int const cpu_column{22};
+  int const memory_column{30};
+  int const running_column{38};
+  int const total_column{46};
+  int const time_column{54};
+  int const state_column{64};
+  mvwprintw(window, ++row, host_column, "%s",
+            string(window->_maxx - 2, ' ').c_str());
+  mvwprintw(window, row, host_column, "Hosts: %zu", hosts.size());
+  if (!warnings.empty()) {
+    // Inputs with lines that did not parse; the first one is shown
+    wattron(window, COLOR_PAIR(3));
+    string warning = "  " + warnings.front();
+    if (warnings.size() > 1) {
+      warning += " (+" + to_string(warnings.size() - 1) + " more)";
+    }
+    waddnstr(window, warning.c_str(), window->_maxx - getcurx(window));
+    wattroff(window, COLOR_PAIR(3));
+  }
+  wattron(window, COLOR_PAIR(2));
+  mvwprintw(window, ++row, host_column, "HOST");
+  mvwprintw(window, row, cpu_column, "CPU[%%]");
+  mvwprintw(window, row, memory_column, "MEM[%%]");
+  mvwprintw(window, row, running_column, "RUN");
+  mvwprintw(window, row, total_column, "PROCS");
+  mvwprintw(window, row, time_column, "UP TIME");
+  mvwprintw(window, row, state_column, "STATE");
+  wattroff(window, COLOR_PAIR(2));
+  int nOfHosts = hosts.size();
+  for (int i = 0; i < n && i < nOfHosts; ++i) {
+    Aggregator::Host const& host = *hosts[i];
+    mvwprintw(window, ++row, host_column, (string(window->_maxx-2, ' ').c_str()));
+    if (host.stale) wattron(window, A_DIM);
+    std::string_view name =
+        Format::Truncate(host.name, cpu_column - host_column - 1);
+    mvwaddnstr(window, row, host_column, name.data(), name.size());
+    mvwprintw(window, row, cpu_column, to_string(host.cpu).substr(0, 4).c_str());
+    mvwprintw(window, row, memory_column,
+              to_string(host.memory).substr(0, 4).c_str());
+    mvwprintw(window, row, running_column, to_string(host.running).c_str());
+    mvwprintw(window, row, total_column, to_string(host.total).c_str());
+    mvwprintw(window, row, time_column,
+              Format::ElapsedTime(host.uptime).c_str());
+    mvwprintw(window, row, state_column, host.stale ? "stale" : "live");
+    if (host.stale) wattroff(window, A_DIM);
+  }
+  wrefresh(window);
+}
+
+// Fleet view: the host summary takes the place of the system panel and
+// the process table lists the busiest processes across all hosts
+void NCursesDisplay::DisplayFleet(Aggregator& fleet, int n, int hosts) {
+  initscr();      // start ncurses
+  noecho();       // do not print input values
+  cbreak();       // terminate ncurses on ctrl + c
+  start_color();  // enable color
+  running = 1;
+  signal(SIGINT, stop);
+  signal(SIGTERM, stop);
+
+  int x_max{getmaxx(stdscr)};
+  WINDOW* host_window = newwin(4 + hosts, x_max - 1, 0, 0);
+  WINDOW* process_window =
+      newwin(3 + n, x_max - 1, host_window->_maxy + 1, 0);
+  init_pair(1, COLOR_BLUE, COLOR_BLACK);
+  init_pair(2, COLOR_GREEN, COLOR_BLACK);
+  init_pair(3, COLOR_RED, COLOR_BLACK);
+
+  auto next = std::chrono::steady_clock::now();
+  while (running) {
+    // Keep reading between frames, but redraw at most once a second
+    auto now = std::chrono::steady_clock::now();
+    if (now < next) {
+      fleet.Poll(std::chrono::duration_cast<std::chrono::milliseconds>(
+                     next - now).count());
+      continue;
+    }
+    next = now + std::chrono::seconds(1);
+    std::vector<Process> top = fleet.Top(n).Sorted();
+    box(host_window, 0, 0);
+    box(process_window, 0, 0);
+    DisplayHosts(fleet.Hosts(), fleet.Warnings(), host_window, hosts);
+    DisplayProcesses(top, process_window, n);
+    wrefresh(host_window);
+    wrefresh(process_window);
+    refresh();
   }
   endwin();
 }
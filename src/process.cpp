@@ -1,7 +1,9 @@
 #include <unistd.h>
 #include <cctype>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <linux_parser.h>
 
@@ -11,43 +13,124 @@ using std::string;
 using std::to_string;
 using std::vector;
 
-Process::Process(int pid): pid{pid}
+namespace {
+// /etc/passwd is read once per distinct uid rather than once per process.
+// Names are cached, not handles, since handles are released by Sweep().
+string const& userName(string const& uid)
 {
-    user = LinuxParser::User(pid);
-    cmd = LinuxParser::Command(pid);
+    static std::mutex mutex;
+    static std::unordered_map<string, string> users;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = users.find(uid);
+    if (found == users.end())
+    {
+        found = users.emplace(uid, LinuxParser::UserFromUid(uid)).first;
+    }
+    return found->second;
 }
+}  // namespace
 
-// DONE: Return this process's ID
-int Process::Pid() const { return pid; }
+// Row built from an already read /proc/[pid]/stat; scanners pass the
+// system uptime in so it is not re-read for every PID. No strings are
+// interned here, so scan threads never contend on the interner:
+// LoadName() or LoadDetails() fill them in for the rows that are kept.
+Process::Process(int pid, vector<string> const& stat, long systemUpTime)
+    : pid{pid}, user{0}, cmd{0}
+{
+    ram = LinuxParser::Rss(stat) / 1000;
+    uptime = LinuxParser::UpTime(stat, systemUpTime);
+    jiffies = LinuxParser::ActiveJiffies(stat);
+    start = LinuxParser::StartTime(stat);
+    cpu = 0;
+    if (uptime != 0)
+    {
+        cpu = 100 * ((float) jiffies / sysconf(_SC_CLK_TCK)) / (float) uptime;
+    }
+}
 
-// DONE: Return this process's CPU utilization
-float Process::CpuUtilization() const {
-    long total_time = LinuxParser::ActiveJiffies(Pid());
-    float up_time = UpTime();
-    if (up_time == 0)
+// Row rebuilt from recorded values, e.g. another host's record stream
+Process::Process(int pid, std::string_view user, std::string_view command,
+                 float cpu, long ramMb, long upTime)
+    : pid{pid}, cpu{cpu}, ram{ramMb}, uptime{upTime}, jiffies{0}, start{0}
+{
+    StringInterner& interner = StringInterner::Global();
+    this->user = interner.Intern(user);
+    cmd = interner.Intern(command);
+}
+
+// Use the short name from stat as the command, for a cheap first frame
+void Process::LoadName()
+{
+    vector<string> stat = LinuxParser::Stat(pid);
+    if (stat.size() > 1)
     {
-        return 0;
+        cmd = StringInterner::Global().Intern(stat[1]);
     }
-    return 100 * ((float) total_time / sysconf(_SC_CLK_TCK)) / (float) up_time;
 }
 
+// Read the user, RAM and full command line
+void Process::LoadDetails()
+{
+    vector<string> status = LinuxParser::Status(
+        pid, {LinuxParser::filterUid, LinuxParser::filterVmRSS});
+    if (!status[0].empty())
+    {
+        user = StringInterner::Global().Intern(userName(status[0]));
+    }
+    ram = safe_convert<long>(status[1]) / 1000;
+    string command = LinuxParser::Command(pid);
+    if (!command.empty())
+    {
+        cmd = StringInterner::Global().Intern(command);
+    }
+}
+
+// Keep this row's strings alive across the next StringInterner::Sweep()
+void Process::Mark() const
+{
+    StringInterner& interner = StringInterner::Global();
+    interner.Mark(user);
+    interner.Mark(cmd);
+}
+
+// Replace the lifetime average with the rate since a previous sample;
+// elapsedJiffies is the wall time per core, in clock ticks
+void Process::Interval(long previousJiffies, float elapsedJiffies)
+{
+    if (elapsedJiffies > 0 && jiffies >= previousJiffies)
+    {
+        cpu = 100 * (float) (jiffies - previousJiffies) / elapsedJiffies;
+    }
+}
+
+// DONE: Return this process's ID
+int Process::Pid() const { return pid; }
+
+// DONE: Return this process's CPU utilization
+float Process::CpuUtilization() const { return cpu; }
+
 // DONE: Return the command that generated this process
-string Process::Command() const { 
-  if (cmd.size() > 40)
-  {
-    return cmd.substr(0, 40) + "...";
-  }
-  return cmd;
+// Full command line; truncate with Format::Truncate when rendering
+std::string_view Process::Command() const {
+  return StringInterner::Global().View(cmd);
 }
 
 // DONE: Return this process's memory utilization
-string Process::Ram() const { return LinuxParser::Ram(Pid()); }
+string Process::Ram() const { return to_string(ram); }
+
+long Process::RamMb() const { return ram; }
+
+long Process::Jiffies() const { return jiffies; }
+
+long Process::StartTime() const { return start; }
 
 // DONE: Return the user (name) that generated this process
-string Process::User() const { return user; }
+std::string_view Process::User() const {
+  return StringInterner::Global().View(user);
+}
 
 // DONE: Return the age of this process (in seconds)
-long int Process::UpTime() const { return LinuxParser::UpTime(Pid()); }
+long int Process::UpTime() const { return uptime; }
 
 // DONE: Overload the "less than" comparison operator for Process objects
 // REMOVE: [[maybe_unused]] once you define the function
@@ -1,7 +1,34 @@
+#include <string>
+#include <vector>
+
 #include "processor.h"
 #include <linux_parser.h>
 
 // DONE: Return the aggregate CPU utilization
-float Processor::Utilization() {
-    return (float) LinuxParser::ActiveJiffies() / (float) LinuxParser::Jiffies();
-}
\ No newline at end of file
+float Processor::Utilization() { return utilization_; }
+
+void Processor::Update() {
+    std::vector<std::string> cpu = LinuxParser::CpuUtilization();
+    long total = LinuxParser::Jiffies(cpu);
+    long active = total - LinuxParser::IdleJiffies(cpu);
+    if (total_ > 0 && total > total_)
+    {
+        utilization_ = (float) (active - active_) / (float) (total - total_);
+    }
+    else if (total > 0)
+    {
+        utilization_ = (float) active / (float) total;
+    }
+    active_ = active;
+    total_ = total;
+}
+
+// Seed the previous sample, e.g. from a warm-start file
+void Processor::Baseline(long active, long total) {
+    active_ = active;
+    total_ = total;
+}
+
+long Processor::ActiveJiffies() const { return active_; }
+
+long Processor::Jiffies() const { return total_; }
@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <chrono>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+#include "record.h"
+
+using std::string;
+
+// Wall clock in milliseconds; hosts are aligned on this
+long Record::Now() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+// Write the current snapshot of system as one tick; the caller refreshes
+// it first, and ScanTop(n) is enough for the n rows written
+void Record::Write(std::ostream& out, System& system, string const& host,
+                   std::size_t n) {
+  long now = Now();
+  out << "H " << now << " " << host << " "
+      << system.Cpu().Utilization() * 100 << " "
+      << system.MemoryUtilization() * 100 << " " << system.RunningProcesses()
+      << " " << system.TotalProcesses() << " " << system.UpTime() << "\n";
+  auto& processes = system.Processes();
+  for (std::size_t i = 0; i < n && i < processes.size(); i++) {
+    Process const& proc = processes[i];
+    string user{proc.User()};
+    string command{proc.Command()};
+    // Keep one entry per line whatever the command line contains
+    std::replace(command.begin(), command.end(), '\n', ' ');
+    std::replace(command.begin(), command.end(), '\0', ' ');
+    out << "P " << now << " " << proc.Pid() << " " << proc.CpuUtilization()
+        << " " << proc.RamMb() << " " << proc.UpTime() << " "
+        << (user.empty() ? "-" : user) << " "
+        << (command.empty() ? "-" : command) << "\n";
+  }
+}
+
+// Parse one line; malformed lines are rejected rather than half-filled
+bool Record::Parse(string const& line, Entry& entry) {
+  // Callers reuse one entry; nothing may carry over from the last line
+  entry = Entry{};
+  std::istringstream linestream(line);
+  string kind;
+  if (!(linestream >> kind >> entry.timestamp) || kind.size() != 1) {
+    return false;
+  }
+  entry.kind = kind[0];
+  if (entry.kind == 'H') {
+    return static_cast<bool>(linestream >> entry.host >> entry.cpu >>
+                             entry.memory >> entry.running >> entry.total >>
+                             entry.uptime);
+  }
+  if (entry.kind == 'P') {
+    if (!(linestream >> entry.pid >> entry.cpu >> entry.ram >> entry.uptime >>
+          entry.user)) {
+      return false;
+    }
+    if (entry.user == "-") {
+      entry.user.clear();
+    }
+    std::getline(linestream >> std::ws, entry.command);
+    if (entry.command == "-") {
+      entry.command.clear();
+    }
+    return true;
+  }
+  return false;
+}
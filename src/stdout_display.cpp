@@ -3,6 +3,7 @@
 #include <iostream>
 #include <algorithm>
 
+#include "format.h"
 #include "stdout_display.h"
 #include "system.h"
 #include <linux_parser.h>
@@ -24,25 +25,40 @@ void StdOutDisplay::DisplaySystem(System& system) {
   cout << "RunningProcesses " << system.RunningProcesses() << "\n";
 }
 
-void StdOutDisplay::DisplayProcesses(std::vector<Process>& processes, int n) {
-  std::sort(processes.begin(), processes.end());
-  float total = 0;
+// processes is expected busiest first, as returned by System::ScanTop()
+void StdOutDisplay::DisplayProcesses(std::vector<Process>& processes, int n,
+                                     float total) {
   for (int i = 0; i < n && i < (int)processes.size(); ++i) {
     Process &proc = processes[i];
     cout << proc.Pid() << "\t";
     cout << proc.UpTime() << "s\t"; 
     cout << proc.CpuUtilization() << "%\t";
     cout << proc.Ram() << "MB\t";
-    cout << proc.Command() << "s\n"; 
-  }
-  for (auto proc : processes)
-  {
-    total += proc.CpuUtilization();
+    cout << Format::Truncate(proc.Command(), 40);
+    cout << (proc.Command().size() > 40 ? "..." : "") << "s\n";
   }
   cout << "TOTAL!" << total << endl;
 }
 
 void StdOutDisplay::Display(System& system, int n) {
+  std::vector<Process>& processes = system.ScanTop(n);
   DisplaySystem(system);
-  DisplayProcesses(system.Processes(), n);
+  DisplayProcesses(processes, n, system.TotalCpu());
+}
+
+// TOTAL! sums the recorded process rows of live hosts, as a single
+// host's TOTAL! sums its listed processes
+void StdOutDisplay::DisplayFleet(Aggregator& fleet, int n) {
+  for (Aggregator::Host const* host : fleet.Hosts()) {
+    cout << host->name << "\t";
+    cout << host->cpu << "%\t";
+    cout << host->memory << "%\t";
+    cout << host->running << "/" << host->total << "\t";
+    cout << host->uptime << "s";
+    cout << (host->stale ? "\tstale\n" : "\n");
+  }
+  cout << "\n";
+  TopK top = fleet.Top(n);
+  std::vector<Process> processes = top.Sorted();
+  DisplayProcesses(processes, n, top.TotalCpu());
 }
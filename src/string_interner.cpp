@@ -0,0 +1,111 @@
+#include <cstring>
+#include <string_view>
+
+#include "string_interner.h"
+
+using std::string_view;
+
+StringInterner::StringInterner() {
+  strings_.emplace_back();
+  marked_.push_back(true);
+  index_.emplace(string_view{}, 0);
+}
+
+StringInterner& StringInterner::Global() {
+  static StringInterner interner;
+  return interner;
+}
+
+// Copy s into the arena; views into a block stay valid because blocks
+// are never reallocated. Oversized strings get a block of their own.
+string_view StringInterner::Store(string_view s) {
+  live_bytes_ += s.size();
+  if (s.size() > kBlockSize) {
+    blocks_.emplace_back(new char[s.size()]);
+    arena_bytes_ += s.size();
+    std::memcpy(blocks_.back().get(), s.data(), s.size());
+    return string_view{blocks_.back().get(), s.size()};
+  }
+  if (current_ == nullptr || used_ + s.size() > kBlockSize) {
+    blocks_.emplace_back(new char[kBlockSize]);
+    arena_bytes_ += kBlockSize;
+    current_ = blocks_.back().get();
+    used_ = 0;
+  }
+  char* dest = current_ + used_;
+  std::memcpy(dest, s.data(), s.size());
+  used_ += s.size();
+  return string_view{dest, s.size()};
+}
+
+StringInterner::Handle StringInterner::Intern(string_view s) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto found = index_.find(s);
+  if (found != index_.end()) {
+    return found->second;
+  }
+  string_view stored = Store(s);
+  Handle handle;
+  if (!free_.empty()) {
+    handle = free_.back();
+    free_.pop_back();
+    strings_[handle] = stored;
+  } else {
+    handle = static_cast<Handle>(strings_.size());
+    strings_.push_back(stored);
+    marked_.push_back(false);
+  }
+  index_.emplace(stored, handle);
+  return handle;
+}
+
+string_view StringInterner::View(Handle handle) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (handle >= strings_.size()) {
+    return string_view{};
+  }
+  return strings_[handle];
+}
+
+void StringInterner::Mark(Handle handle) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (handle < marked_.size()) {
+    marked_[handle] = true;
+  }
+}
+
+// Release every string not marked since the last sweep. Non-empty
+// strings never use handle 0, so an empty view marks a free slot.
+void StringInterner::Sweep() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (Handle handle = 1; handle < strings_.size(); handle++) {
+    if (!marked_[handle] && !strings_[handle].empty()) {
+      index_.erase(strings_[handle]);
+      live_bytes_ -= strings_[handle].size();
+      strings_[handle] = string_view{};
+      free_.push_back(handle);
+    }
+    marked_[handle] = false;
+  }
+  if (arena_bytes_ > kBlockSize && live_bytes_ * 2 < arena_bytes_) {
+    Compact();
+  }
+}
+
+// Copy the live strings into fresh blocks; handles stay the same
+void StringInterner::Compact() {
+  std::vector<std::unique_ptr<char[]>> old;
+  old.swap(blocks_);
+  current_ = nullptr;
+  used_ = 0;
+  arena_bytes_ = 0;
+  live_bytes_ = 0;
+  index_.clear();
+  index_.emplace(string_view{}, 0);
+  for (Handle handle = 1; handle < strings_.size(); handle++) {
+    if (!strings_[handle].empty()) {
+      strings_[handle] = Store(strings_[handle]);
+      index_.emplace(strings_[handle], handle);
+    }
+  }
+}
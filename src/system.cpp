@@ -6,10 +6,16 @@
 #include <linux_parser.h>
 #include <iostream>
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <thread>
+#include <utility>
 
 #include "process.h"
 #include "processor.h"
 #include "system.h"
+#include "top_k.h"
 
 using namespace std;
 
@@ -23,36 +29,208 @@ System::System()
 // DONE: Return the system's CPU
 Processor& System::Cpu() { return cpu_; }
 
-// DONE: Return a container composed of the system's processes
-vector<Process>& System::Processes() {
-  processes_.clear();
+// Sample the system-wide counters shown in the system panel
+void System::RefreshCounters() {
+  cpu_.Update();
+  memory_utilization_ = LinuxParser::MemoryUtilization();
+  memory_available_ = LinuxParser::MemoryAvailable();
+  up_time_ = LinuxParser::UpTime();
+  total_processes_ = LinuxParser::TotalProcesses();
+  running_processes_ = LinuxParser::RunningProcesses();
+}
+
+// Processes idle since start or without resident memory are not listed
+bool System::Listed(Process const& proc) {
+  return proc.CpuUtilization() > 0 && proc.RamMb() > 0;
+}
+
+// Stream every PID through per-thread TopK heaps, keeping the k busiest.
+// Only /proc/[pid]/stat is read; callers load details for the rows they
+// keep. The jiffies seen become the baselines for the next scan.
+TopK System::Scan(size_t k) {
   vector<int> pids = LinuxParser::Pids();
-  for (int pid : pids)
+  size_t threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = std::min(threads, pids.size() / kPidsPerThread + 1);
+
+  float elapsed = 0;
+  if (baseline_jiffies_ > 0)
+  {
+    elapsed = (float) (cpu_.Jiffies() - baseline_jiffies_) /
+              sysconf(_SC_NPROCESSORS_ONLN);
+  }
+
+  vector<TopK> partial(threads, TopK(k));
+  vector<vector<std::pair<int, Baseline>>> seen(threads);
+  vector<std::thread> workers;
+  for (size_t t = 0; t < threads; t++)
+  {
+    workers.emplace_back([&, t] {
+      for (size_t i = t; i < pids.size(); i += threads)
+      {
+        vector<string> stat = LinuxParser::Stat(pids[i]);
+        if (stat.empty())
+        {
+          continue;
+        }
+        Process proc = Process(pids[i], stat, up_time_);
+        seen[t].push_back({pids[i], {proc.StartTime(), proc.Jiffies()}});
+        if (!Listed(proc))
+        {
+          continue;
+        }
+        auto previous = baseline_.find(pids[i]);
+        if (previous != baseline_.end() &&
+            previous->second.start == proc.StartTime())
+        {
+          proc.Interval(previous->second.jiffies, elapsed);
+        }
+        partial[t].Push(proc);
+      }
+    });
+  }
+  for (std::thread& worker : workers)
+  {
+    worker.join();
+  }
+
+  baseline_.clear();
+  for (auto const& entries : seen)
+  {
+    baseline_.insert(entries.begin(), entries.end());
+  }
+  baseline_jiffies_ = cpu_.Jiffies();
+
+  for (size_t t = 1; t < threads; t++)
+  {
+    partial[0].Merge(partial[t]);
+  }
+  total_cpu_ = partial[0].TotalCpu();
+  return partial[0];
+}
+
+// Sample every system-wide counter and rescan the whole process table
+// from stat, so alerts see every process; only the n busiest rows shown
+// get their user and command line
+void System::Refresh(size_t n) {
+  RefreshCounters();
+  processes_ = Scan(std::numeric_limits<size_t>::max()).Sorted();
+  RefreshDetails(n);
+}
+
+// Cheap stat-only ranking of the n busiest processes, for a first frame;
+// RefreshDetails() then fills in users and command lines
+void System::RefreshRanking(size_t n) {
+  processes_ = Scan(n).Sorted();
+  for (Process& proc : processes_)
+  {
+    proc.LoadName();
+  }
+  Collect();
+}
+
+// Read status and cmdline for the n busiest rows
+void System::RefreshDetails(size_t n) {
+  for (size_t i = 0; i < n && i < processes_.size(); i++)
   {
-    Process proc = Process(pid);
-    if (proc.CpuUtilization() > 0 && safe_convert<int>(proc.Ram()) > 0)
+    processes_[i].LoadDetails();
+  }
+  Collect();
+}
+
+// Release interned strings no longer used by the process table
+void System::Collect() {
+  for (Process const& proc : processes_)
+  {
+    proc.Mark();
+  }
+  StringInterner::Global().Sweep();
+}
+
+// Sample the counters and keep only the k busiest processes; status and
+// cmdline are read for those k rows only
+vector<Process>& System::ScanTop(size_t k) {
+  RefreshCounters();
+  processes_ = Scan(k).Sorted();
+  RefreshDetails(k);
+  return processes_;
+}
+
+// CPU summed over every listed process of the last scan, not just the
+// rows kept
+float System::TotalCpu() { return total_cpu_; }
+
+/*
+Warm-start file: jiffy baselines from a previous session, so the first
+frame shows rates over a real interval instead of lifetime averages.
+  boot <boot id>
+  cpu <active jiffies> <total jiffies>
+  <pid> <start time> <jiffies>
+It is ignored when written during a different boot.
+*/
+bool System::LoadState(string const& path) {
+  std::ifstream stream(path);
+  string key, boot;
+  long active = 0, total = 0;
+  if (!(stream >> key >> boot) || key != "boot" ||
+      boot != LinuxParser::BootId())
+  {
+    return false;
+  }
+  if (!(stream >> key >> active >> total) || key != "cpu")
+  {
+    return false;
+  }
+  cpu_.Baseline(active, total);
+  baseline_jiffies_ = total;
+  baseline_.clear();
+  int pid;
+  Baseline baseline;
+  while (stream >> pid >> baseline.start >> baseline.jiffies)
+  {
+    baseline_[pid] = baseline;
+  }
+  return true;
+}
+
+// Written to a temporary file first so a reader never sees half a state
+bool System::SaveState(string const& path) {
+  string temporary = path + ".tmp";
+  {
+    std::ofstream stream(temporary);
+    stream << "boot " << LinuxParser::BootId() << "\n";
+    stream << "cpu " << cpu_.ActiveJiffies() << " " << cpu_.Jiffies() << "\n";
+    for (auto const& [pid, baseline] : baseline_)
     {
-    	processes_.push_back(proc);
+      stream << pid << " " << baseline.start << " " << baseline.jiffies << "\n";
+    }
+    if (!stream)
+    {
+      return false;
     }
   }
-  std::sort(processes_.begin(), processes_.end());
-  return processes_;
+  return std::rename(temporary.c_str(), path.c_str()) == 0;
 }
 
+// DONE: Return a container composed of the system's processes
+vector<Process>& System::Processes() { return processes_; }
+
 // DONE: Return the system's kernel identifier (string)
 std::string System::Kernel() { return kernel_; }
 
 // DONE: Return the system's memory utilization
-float System::MemoryUtilization() { return LinuxParser::MemoryUtilization(); }
+float System::MemoryUtilization() { return memory_utilization_; }
+
+// Return the fraction of memory available for new allocations
+float System::MemoryAvailable() { return memory_available_; }
 
 // DONE: Return the operating system name
 std::string System::OperatingSystem() { return os_; }
 
 // DONE: Return the number of processes actively running on the system
-int System::RunningProcesses() { return LinuxParser::RunningProcesses(); }
+int System::RunningProcesses() { return running_processes_; }
 
 // DONE: Return the total number of processes on the system
-int System::TotalProcesses() { return LinuxParser::TotalProcesses(); }
+int System::TotalProcesses() { return total_processes_; }
 
 // DONE: Return the number of seconds since the system started running
-long int System::UpTime() { return LinuxParser::UpTime(); }
\ No newline at end of file
+long int System::UpTime() { return up_time_; }
\ No newline at end of file
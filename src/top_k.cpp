@@ -0,0 +1,47 @@
+#include <algorithm>
+#include <vector>
+
+#include "top_k.h"
+
+using std::vector;
+
+namespace {
+// Min-heap on CPU: the root is the weakest of the current top K
+bool higherCpu(Process const& a, Process const& b) { return b < a; }
+}  // namespace
+
+TopK::TopK(std::size_t k) : k_{k} {}
+
+void TopK::Push(Process const& proc) {
+  total_cpu_ += proc.CpuUtilization();
+  Insert(proc);
+}
+
+void TopK::Insert(Process const& proc) {
+  if (k_ == 0) {
+    return;
+  }
+  if (heap_.size() < k_) {
+    heap_.push_back(proc);
+    std::push_heap(heap_.begin(), heap_.end(), higherCpu);
+  } else if (heap_.front() < proc) {
+    std::pop_heap(heap_.begin(), heap_.end(), higherCpu);
+    heap_.back() = proc;
+    std::push_heap(heap_.begin(), heap_.end(), higherCpu);
+  }
+}
+
+void TopK::Merge(TopK const& other) {
+  for (Process const& proc : other.heap_) {
+    Insert(proc);
+  }
+  total_cpu_ += other.total_cpu_;
+}
+
+vector<Process> TopK::Sorted() const {
+  vector<Process> sorted = heap_;
+  std::sort_heap(sorted.begin(), sorted.end(), higherCpu);
+  return sorted;
+}
+
+float TopK::TotalCpu() const { return total_cpu_; }